@@ -0,0 +1,235 @@
+/*****************************************************************************************************
+ * Automatische EAN-13-Barcodeerkennung mit OpenCV.
+ *****************************************************************************************************
+ * Autor: [Moussa Elgamal]
+ * Version: 04.02.2024
+ * Beschreibung:
+				Dieses C++-Programm implementiert die automatische EAN-13-Barcodeerkennung mithilfe der OpenCV-Bibliothek.
+				Es bietet vier Modi: Erstellen, Lesen, Aktualisieren und Lschen von Produktinformationen.
+				Das System erfasst Bilder, verbessert die Barcodeerkennung und ermglicht die Interaktion mit der Datenbank
+				fr verschiedene Anwendungsflle.
+ *****************************************************************************************************/
+
+/*
+ * Catalog benchmark. Build with CATALOG_BENCHMARK added to the preprocessor definitions; this file
+ * then provides main() instead of the scanner in main.cpp. Run it from a scratch directory:
+ *
+ *     Barcode_Recognition.exe [rows]     (default 1000000 rows)
+ *
+ * It writes a synthetic catalog to benchmark_catalog.csv and parses it with the former
+ * getline/istringstream reader and with loadProductDatabase(), then compares the memory of the
+ * loaded ProductCatalog with a vector<ProductInfo> holding the same products, and times GS1 prefix
+ * queries and single inserts/erases on the ordered index against a full scan.
+ */
+#ifdef CATALOG_BENCHMARK
+
+/* Include files */
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <random>
+#include <chrono>
+#include <vector>
+#include "crudOperations.h"
+#include "catalogLoader.h"
+
+/* Namespaces */
+using namespace std;
+using namespace ip;
+
+
+/* Prototypes */
+string makeEAN13(uint64_t firstTwelveDigits);
+void writeSyntheticCatalog(const string& csvFilePath, size_t rowCount);
+vector<ProductInfo> loadWithGetline(const string& csvFilePath);
+double millisecondsSince(chrono::steady_clock::time_point startTime);
+void benchmarkLoader(const string& csvFilePath);
+size_t stringHeapBytes(const string& text);
+vector<ProductInfo> benchmarkMemory();
+void benchmarkPrefixQueries(const vector<ProductInfo>& products);
+
+
+/* Main function */
+int main(int argc, char* argv[]) {
+    const size_t rowCount = (argc > 1) ? stoul(argv[1]) : 1000000;
+    const string csvFilePath = "benchmark_catalog.csv";
+
+    cout << "Writing " << rowCount << " synthetic products to " << csvFilePath << endl;
+    writeSyntheticCatalog(csvFilePath, rowCount);
+
+    benchmarkLoader(csvFilePath);
+    const vector<ProductInfo> products = benchmarkMemory();
+    benchmarkPrefixQueries(products);
+    return 0;
+}
+
+
+// Function to append the EAN-13 check digit to 12 digits
+string makeEAN13(uint64_t firstTwelveDigits) {
+    string barcode = ProductCatalog::decodeBarcode(firstTwelveDigits * 10);
+
+    int calculatedChecksum = 0;
+    for (int i = 0; i < 12; ++i) {
+        int digit = barcode[i] - '0';
+        calculatedChecksum += (i % 2 == 0) ? digit : digit * 3;
+    }
+    int mod = calculatedChecksum % 10;
+    barcode[12] = static_cast<char>('0' + ((mod == 0) ? 0 : 10 - mod));
+
+    return barcode;
+}
+
+
+// Function to write a catalog with random EANs; every 10th product name contains a quoted comma
+void writeSyntheticCatalog(const string& csvFilePath, size_t rowCount) {
+    mt19937_64 random(2024);
+    ofstream outFile(csvFilePath);
+
+    outFile << "Barcode Type,Barcode Number,Product Name,Product Description" << endl;
+    for (size_t i = 0; i < rowCount; ++i) {
+        const string name = (i % 10 == 0) ? "Product " + to_string(i) + ", boxed" : "Product " + to_string(i);
+        outFile << "EAN13," << makeEAN13(random() % 1000000000000ULL) << ','
+            << quoteCsvField(name) << ",Synthetic description of product number " << i << '\n';
+    }
+}
+
+
+// The reader crudOperations.cpp used before the parallel loader, applied to every row
+vector<ProductInfo> loadWithGetline(const string& csvFilePath) {
+    vector<ProductInfo> products;
+    ifstream inFile(csvFilePath);
+
+    string line;
+    getline(inFile, line); // Skip the header
+
+    while (getline(inFile, line)) {
+        istringstream iss(line);
+        vector<string> tokens;
+        string token;
+
+        while (getline(iss, token, ',')) {
+            tokens.push_back(token);
+        }
+
+        if (tokens.size() == 4) {
+            products.push_back(ProductInfo{ tokens[0], tokens[1], tokens[2], tokens[3] });
+        }
+    }
+
+    return products;
+}
+
+
+double millisecondsSince(chrono::steady_clock::time_point startTime) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+}
+
+
+// Function to compare startup time and rows per second of both readers on the same file
+void benchmarkLoader(const string& csvFilePath) {
+    auto startTime = chrono::steady_clock::now();
+    const vector<ProductInfo> legacyProducts = loadWithGetline(csvFilePath);
+    const double legacyMilliseconds = millisecondsSince(startTime);
+
+    CatalogLoadStatistics statistics;
+    loadProductDatabase(csvFilePath, &statistics);
+
+    cout << "\n[Loader]" << endl;
+    cout << "getline/istringstream: " << legacyMilliseconds << " ms, "
+        << static_cast<size_t>(statistics.rowsParsed * 1000.0 / legacyMilliseconds) << " rows/s, "
+        << legacyProducts.size() << " products (rows with quoted commas are dropped)" << endl;
+    cout << "loadProductDatabase:   " << statistics.elapsedMilliseconds << " ms, "
+        << static_cast<size_t>(statistics.rowsParsed * 1000.0 / statistics.elapsedMilliseconds) << " rows/s, "
+        << statistics.productsAdded << " products on " << statistics.threadCount << " thread(s)" << endl;
+}
+
+// Heap block of a string, zero while it fits into the small-string buffer (allocator overhead not counted)
+size_t stringHeapBytes(const string& text) {
+    static const size_t smallStringCapacity = string().capacity();
+    return (text.capacity() > smallStringCapacity) ? text.capacity() + 1 : 0;
+}
+
+
+// Function to compare bytes per product of the catalog loaded by benchmarkLoader() with a vector of structs
+vector<ProductInfo> benchmarkMemory() {
+    const ProductCatalog& catalog = getProductDatabase();
+
+    vector<ProductInfo> products;
+    products.reserve(catalog.size());
+    for (const ProductView& product : catalog.findByPrefix("")) {
+        products.push_back(product.toProductInfo());
+    }
+
+    size_t vectorBytes = products.capacity() * sizeof(ProductInfo);
+    for (const ProductInfo& product : products) {
+        vectorBytes += stringHeapBytes(product.barcodeType) + stringHeapBytes(product.barcodeNumber)
+            + stringHeapBytes(product.productName) + stringHeapBytes(product.productDescription);
+    }
+
+    cout << "\n[Memory] " << catalog.size() << " products" << endl;
+    cout << "vector<ProductInfo>: " << vectorBytes / products.size() << " bytes per product (no lookup index)" << endl;
+    cout << "ProductCatalog:      " << catalog.memoryUsage() / catalog.size() << " bytes per product (including its indexes)" << endl;
+
+    return products;
+}
+
+
+// Function to time prefix queries of different lengths on the ordered index and on a full scan of the same products
+void benchmarkPrefixQueries(const vector<ProductInfo>& products) {
+    const ProductCatalog& catalog = getProductDatabase();
+    const size_t queryCount = 1000;
+    const size_t scanCount = 5;
+    mt19937_64 random(7);
+
+    cout << "\n[Prefix queries] " << catalog.size() << " products" << endl;
+    for (size_t prefixLength : { 3, 7, 9 }) {
+        // Prefixes of existing products, so every query has at least one result
+        vector<string> prefixes;
+        for (size_t i = 0; i < queryCount; ++i) {
+            prefixes.push_back(products[random() % products.size()].barcodeNumber.substr(0, prefixLength));
+        }
+
+        size_t resultCount = 0;
+        auto startTime = chrono::steady_clock::now();
+        for (const string& prefix : prefixes) {
+            resultCount += catalog.findByPrefix(prefix).size();
+        }
+        const double indexMicroseconds = millisecondsSince(startTime) * 1000.0 / queryCount;
+
+        startTime = chrono::steady_clock::now();
+        for (size_t i = 0; i < scanCount; ++i) {
+            vector<const ProductInfo*> matches;
+            for (const ProductInfo& product : products) {
+                if (product.barcodeNumber.compare(0, prefixLength, prefixes[i]) == 0) {
+                    matches.push_back(&product);
+                }
+            }
+        }
+        const double scanMicroseconds = millisecondsSince(startTime) * 1000.0 / scanCount;
+
+        cout << prefixLength << "-digit prefix: " << resultCount / queryCount << " products per query, ordered index "
+            << indexMicroseconds << " us, full scan " << scanMicroseconds << " us" << endl;
+    }
+
+    // Single writes keep the ordered index up to date; erase and re-insert existing products
+    const size_t writeCount = min<size_t>(100000, products.size());
+    ProductCatalog writableCatalog;
+    writableCatalog.append(catalog);
+
+    auto startTime = chrono::steady_clock::now();
+    for (size_t i = 0; i < writeCount; ++i) {
+        writableCatalog.erase(products[i].barcodeNumber);
+    }
+    const double eraseMicroseconds = millisecondsSince(startTime) * 1000.0 / writeCount;
+
+    startTime = chrono::steady_clock::now();
+    for (size_t i = 0; i < writeCount; ++i) {
+        writableCatalog.insert(products[i].barcodeType, products[i].barcodeNumber, products[i].productName,
+            products[i].productDescription);
+    }
+    const double insertMicroseconds = millisecondsSince(startTime) * 1000.0 / writeCount;
+
+    cout << writeCount << " single writes: erase " << eraseMicroseconds << " us, insert " << insertMicroseconds << " us" << endl;
+}
+
+#endif /* CATALOG_BENCHMARK */
@@ -0,0 +1,335 @@
+/*****************************************************************************************************
+ * Automatische EAN-13-Barcodeerkennung mit OpenCV.
+ *****************************************************************************************************
+ * Autor: [Moussa Elgamal]
+ * Version: 04.02.2024
+ * Beschreibung:
+				Dieses C++-Programm implementiert die automatische EAN-13-Barcodeerkennung mithilfe der OpenCV-Bibliothek.
+				Es bietet vier Modi: Erstellen, Lesen, Aktualisieren und Lschen von Produktinformationen.
+				Das System erfasst Bilder, verbessert die Barcodeerkennung und ermglicht die Interaktion mit der Datenbank
+				fr verschiedene Anwendungsflle.
+ *****************************************************************************************************/
+
+
+/* Include files */
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include "catalogLoader.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* Namespaces */
+using namespace std;
+
+
+namespace ip
+{
+	namespace
+	{
+		const size_t CSV_FIELD_COUNT = 4;
+
+		// Read-only memory mapping of a whole file, released on destruction
+		class MappedFile {
+		public:
+			explicit MappedFile(const string& filePath) {
+#ifdef _WIN32
+				fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+					FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+				if (fileHandle == INVALID_HANDLE_VALUE) {
+					return;
+				}
+				LARGE_INTEGER fileSize;
+				if (!GetFileSizeEx(fileHandle, &fileSize)) {
+					return;
+				}
+				if (fileSize.QuadPart == 0) {
+					opened = true;	// an empty file is valid, it just cannot be mapped
+					return;
+				}
+				mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				if (mappingHandle == nullptr) {
+					return;
+				}
+				data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+				size = static_cast<size_t>(fileSize.QuadPart);
+				opened = data != nullptr;
+#else
+				fileDescriptor = open(filePath.c_str(), O_RDONLY);
+				if (fileDescriptor < 0) {
+					return;
+				}
+				struct stat fileStatus;
+				if (fstat(fileDescriptor, &fileStatus) != 0) {
+					return;
+				}
+				opened = true;
+				if (fileStatus.st_size == 0) {
+					return;
+				}
+				void* mapped = mmap(nullptr, static_cast<size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+				if (mapped == MAP_FAILED) {
+					opened = false;
+					return;
+				}
+				madvise(mapped, static_cast<size_t>(fileStatus.st_size), MADV_SEQUENTIAL);
+				data = static_cast<const char*>(mapped);
+				size = static_cast<size_t>(fileStatus.st_size);
+#endif
+			}
+
+			~MappedFile() {
+#ifdef _WIN32
+				if (data != nullptr) UnmapViewOfFile(data);
+				if (mappingHandle != nullptr) CloseHandle(mappingHandle);
+				if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+#else
+				if (data != nullptr) munmap(const_cast<char*>(data), size);
+				if (fileDescriptor >= 0) close(fileDescriptor);
+#endif
+			}
+
+			MappedFile(const MappedFile&) = delete;
+			MappedFile& operator=(const MappedFile&) = delete;
+
+			bool isOpen() const { return opened; }
+			string_view view() const { return data != nullptr ? string_view(data, size) : string_view(); }
+
+		private:
+			const char* data = nullptr;
+			size_t size = 0;
+			bool opened = false;
+#ifdef _WIN32
+			HANDLE fileHandle = INVALID_HANDLE_VALUE;
+			HANDLE mappingHandle = nullptr;
+#else
+			int fileDescriptor = -1;
+#endif
+		};
+
+		// Same checksum as isValidEAN13() in main.cpp, but on a view so rows are validated without copying
+		bool isValidEAN13Field(string_view barcode) {
+			if (barcode.size() != 13) {
+				return false;
+			}
+
+			int calculatedChecksum = 0;
+			for (size_t i = 0; i < 13; ++i) {
+				if (barcode[i] < '0' || barcode[i] > '9') {
+					return false;
+				}
+				if (i < 12) {
+					int digit = barcode[i] - '0';
+					calculatedChecksum += (i % 2 == 0) ? digit : digit * 3;
+				}
+			}
+
+			int mod = calculatedChecksum % 10;
+			int checksum = (mod == 0) ? 0 : 10 - mod;
+			return checksum == (barcode[12] - '0');
+		}
+
+		// Chunks are staged without an index, duplicates are resolved when they are merged in file order
+		struct ChunkResult {
+			ProductCatalog products{ false };
+			size_t rowsParsed = 0;
+			size_t rowsRejected = 0;
+		};
+
+		// Parses all complete lines of one chunk. Chunks always start at the beginning of a line.
+		void parseChunk(string_view chunk, ChunkResult& result) {
+			string_view fields[CSV_FIELD_COUNT];
+			string typeBuffer, nameBuffer, descriptionBuffer;
+			size_t position = 0;
+
+			while (position < chunk.size()) {
+				size_t lineEnd = chunk.find('\n', position);
+				if (lineEnd == string_view::npos) {
+					lineEnd = chunk.size();
+				}
+				string_view line = chunk.substr(position, lineEnd - position);
+				position = lineEnd + 1;
+
+				if (!line.empty() && line.back() == '\r') {
+					line.remove_suffix(1);
+				}
+				if (line.empty()) {
+					continue;
+				}
+
+				++result.rowsParsed;
+				if (splitCsvFields(line, fields, CSV_FIELD_COUNT) != CSV_FIELD_COUNT || !isValidEAN13Field(fields[1])) {
+					++result.rowsRejected;
+					continue;
+				}
+
+				// Fails only if the text arena or the barcode type table is full
+				const bool inserted = result.products.insert(
+					unquoteCsvField(fields[0], typeBuffer),         // Barcode Type
+					fields[1],                                      // Barcode Number
+					unquoteCsvField(fields[2], nameBuffer),         // Product name
+					unquoteCsvField(fields[3], descriptionBuffer)   // Product description
+				);
+				if (!inserted) {
+					++result.rowsRejected;
+				}
+			}
+		}
+	}
+
+
+	size_t splitCsvFields(string_view line, string_view* fields, size_t maxFields) {
+		size_t fieldCount = 0;
+		size_t position = 0;
+
+		while (true) {
+			string_view field;
+			if (position < line.size() && line[position] == '"') {
+				// Quoted field: ends at the first quote that is not part of a "" escape
+				size_t start = ++position;
+				while (position < line.size()) {
+					if (line[position] == '"') {
+						if (position + 1 < line.size() && line[position + 1] == '"') {
+							position += 2;
+							continue;
+						}
+						break;
+					}
+					++position;
+				}
+				field = line.substr(start, position - start);
+
+				// Skip the closing quote and anything up to the next separator
+				position = line.find(',', position);
+				if (position == string_view::npos) {
+					position = line.size();
+				}
+			}
+			else {
+				size_t end = line.find(',', position);
+				if (end == string_view::npos) {
+					end = line.size();
+				}
+				field = line.substr(position, end - position);
+				position = end;
+			}
+
+			if (fieldCount < maxFields) {
+				fields[fieldCount] = field;
+			}
+			++fieldCount;
+
+			if (position >= line.size()) {
+				return fieldCount;
+			}
+			++position;  // Skip the comma
+		}
+	}
+
+
+	string_view unquoteCsvField(string_view field, string& buffer) {
+		if (field.find('"') == string_view::npos) {
+			return field;
+		}
+
+		buffer.clear();
+		for (size_t i = 0; i < field.size(); ++i) {
+			buffer += field[i];
+			if (field[i] == '"' && i + 1 < field.size() && field[i + 1] == '"') {
+				++i;
+			}
+		}
+
+		return buffer;
+	}
+
+
+	string quoteCsvField(string_view field) {
+		if (field.find_first_of(",\"") == string_view::npos) {
+			return string(field);
+		}
+
+		string quoted = "\"";
+		for (char ch : field) {
+			quoted += ch;
+			if (ch == '"') {
+				quoted += '"';
+			}
+		}
+		quoted += '"';
+
+		return quoted;
+	}
+
+
+	bool loadProductDatabase(const string& csvFilePath, CatalogLoadStatistics* statistics) {
+		const auto startTime = chrono::steady_clock::now();
+
+		MappedFile file(csvFilePath);
+		if (!file.isOpen()) {
+			cerr << "Error: Unable to open CSV file for reading." << endl;
+			return false;
+		}
+
+		// Skip the header
+		string_view content = file.view();
+		size_t headerEnd = content.find('\n');
+		content = (headerEnd == string_view::npos) ? string_view() : content.substr(headerEnd + 1);
+
+		// Split the file into one chunk per core, each ending on a line boundary.
+		// Small files are not worth a thread per core.
+		const size_t minimumChunkSize = 64 * 1024;
+		size_t threadCount = max<size_t>(1, thread::hardware_concurrency());
+		threadCount = max<size_t>(1, min(threadCount, content.size() / minimumChunkSize));
+
+		vector<string_view> chunks;
+		size_t chunkStart = 0;
+		for (size_t i = 0; i < threadCount && chunkStart < content.size(); ++i) {
+			size_t chunkEnd = content.size();
+			if (i + 1 < threadCount) {
+				chunkEnd = content.find('\n', max(chunkStart, content.size() * (i + 1) / threadCount));
+				chunkEnd = (chunkEnd == string_view::npos) ? content.size() : chunkEnd + 1;
+			}
+			chunks.push_back(content.substr(chunkStart, chunkEnd - chunkStart));
+			chunkStart = chunkEnd;
+		}
+
+		vector<ChunkResult> results(chunks.size());
+		vector<thread> workers;
+		for (size_t i = 1; i < chunks.size(); ++i) {
+			workers.emplace_back(parseChunk, chunks[i], ref(results[i]));
+		}
+		if (!chunks.empty()) {
+			parseChunk(chunks[0], results[0]);  // The calling thread takes the first chunk
+		}
+		for (thread& worker : workers) {
+			worker.join();
+		}
+
+		// Merge in file order, so the first row of a barcode wins like in getProductInfoFromBarcode()
+		CatalogLoadStatistics loadStatistics;
+		loadStatistics.threadCount = static_cast<unsigned int>(max<size_t>(1, chunks.size()));
+		for (ChunkResult& result : results) {
+			loadStatistics.rowsParsed += result.rowsParsed;
+			loadStatistics.rowsRejected += result.rowsRejected;
+			loadStatistics.productsAdded += addProductsToDatabase(result.products);
+		}
+		loadStatistics.elapsedMilliseconds =
+			chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+
+		if (statistics != nullptr) {
+			*statistics = loadStatistics;
+		}
+		return true;
+	}
+}
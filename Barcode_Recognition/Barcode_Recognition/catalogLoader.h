@@ -0,0 +1,49 @@
+/*****************************************************************************************************
+ * Automatische EAN-13-Barcodeerkennung mit OpenCV.
+ *****************************************************************************************************
+ * Autor: [Moussa Elgamal]
+ * Version: 04.02.2024
+ * Beschreibung:
+				Dieses C++-Programm implementiert die automatische EAN-13-Barcodeerkennung mithilfe der OpenCV-Bibliothek.
+				Es bietet vier Modi: Erstellen, Lesen, Aktualisieren und Lschen von Produktinformationen.
+				Das System erfasst Bilder, verbessert die Barcodeerkennung und ermglicht die Interaktion mit der Datenbank
+				fr verschiedene Anwendungsflle.
+ *****************************************************************************************************/
+
+#pragma once
+#ifndef IP_CATALOG_LOADER_H
+#define IP_CATALOG_LOADER_H
+
+/* Include files */
+#include <string>
+#include <string_view>
+#include "crudOperations.h"
+
+/* Namespaces */
+using namespace std;
+
+namespace ip
+{
+	struct CatalogLoadStatistics {
+		size_t rowsParsed = 0;		// data rows found in the file (header excluded)
+		size_t rowsRejected = 0;	// rows with a wrong field count, an invalid EAN-13 or that did not fit into the catalog
+		size_t productsAdded = 0;	// rows merged into the product database
+		unsigned int threadCount = 0;
+		double elapsedMilliseconds = 0.0;
+	};
+
+	// Splits one CSV line into field views. Double-quoted fields may contain commas and "" escapes;
+	// they are returned without the surrounding quotes (see unquoteCsvField).
+	// Returns the total number of fields, only the first maxFields views are stored.
+	size_t splitCsvFields(string_view line, string_view* fields, size_t maxFields);
+	// Resolves "" escapes. Returns 'field' itself if there are none, otherwise a view of 'buffer'.
+	string_view unquoteCsvField(string_view field, string& buffer);
+	// Encloses the field in double quotes if it contains a comma or a quote, doubling embedded quotes.
+	// Rows are split at every line break, so the field itself must not contain one.
+	string quoteCsvField(string_view field);
+
+	// Memory-maps the CSV file, parses it in one chunk per core and merges all valid rows into the product database.
+	bool loadProductDatabase(const string& csvFilePath, CatalogLoadStatistics* statistics = nullptr);
+}
+
+#endif /* IP_CATALOG_LOADER_H */
@@ -13,10 +13,13 @@
 
 /* Include files */
 #include <iostream>
-#include <sstream>
+#include <algorithm>
 #include <vector>
 #include <fstream>
+#include <chrono>
 #include "crudOperations.h"
+#include "catalogLoader.h"
+#include "productCache.h"
 
 /* Namespaces */
 using namespace std;
@@ -24,7 +27,37 @@ using namespace std;
 
 namespace ip
 {
-	vector<ProductInfo> productDatabase;
+	ProductCatalog productDatabase;
+
+	// Adds all products whose barcode is not yet in the database, returns the number of added products
+	size_t addProductsToDatabase(const ProductCatalog& products) {
+		return productDatabase.append(products);
+	}
+
+	const ProductCatalog& getProductDatabase() {
+		return productDatabase;
+	}
+
+	// Rows are split at every line break when the file is read, so line breaks in user input become spaces
+	static string withoutLineBreaks(const string& text) {
+		string normalized = text;
+		replace_if(normalized.begin(), normalized.end(), [](char ch) { return ch == '\r' || ch == '\n'; }, ' ');
+		return normalized;
+	}
+
+	// Formats one CSV row, quoting fields that contain separators
+	static string formatCsvRow(string_view barcodeType, string_view barcodeNumber, string_view productName,
+		string_view productDescription) {
+		return quoteCsvField(barcodeType) + ',' + quoteCsvField(barcodeNumber) + ','
+			+ quoteCsvField(productName) + ',' + quoteCsvField(productDescription);
+	}
+
+	// Returns true if the CSV line is a product row for the given barcode
+	static bool isProductRow(const string& line, const string& barcode) {
+		string_view fields[4];
+		string buffer;
+		return splitCsvFields(line, fields, 4) == 4 && unquoteCsvField(fields[1], buffer) == barcode;
+	}
 
 	void saveBarcodeInformationCSV(const string& barcodeType, const string& barcodeNumber,
 		const string& productName, const string& productDescription) {
@@ -41,7 +74,7 @@ namespace ip
 			}
 
 			// Schreibe die Daten in die CSV-Datei
-			outFile << barcodeType << "," << barcodeNumber << "," << productName << "," << productDescription << endl;
+			outFile << formatCsvRow(barcodeType, barcodeNumber, productName, productDescription) << endl;
 
 			// Schliee die Datei
 			outFile.close();
@@ -53,69 +86,69 @@ namespace ip
 
 	
 
-	// Function to extract product information from a CSV file based on barcode
+	// Function to get product information from the product database loaded at startup,
+	// recently scanned unknown barcodes are answered from the cache
 	ProductInfo* getProductInfoFromBarcode(const string& barcode) {
-		const string csvFilePath = "barcode_information.csv";
-		ifstream inFile(csvFilePath);
-
-		// Check if the file could be opened
-		if (!inFile.is_open()) {
-			cerr << "Error: Unable to open CSV file for reading." << endl;
+		if (isCachedUnknownBarcode(barcode)) {
 			return nullptr;
 		}
 
-		string line;
-		getline(inFile, line); // Skip the header
+		const auto startTime = chrono::steady_clock::now();
+		ProductView product;
+		const bool found = productDatabase.find(barcode, product);
+		storeDatabaseLookup(barcode, found, chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count());
 
-		while (getline(inFile, line)) {
-			istringstream iss(line);
-			vector<string> tokens;
-			string token;
+		return found ? new ProductInfo(product.toProductInfo()) : nullptr;
+	}
 
-			// Split the line into tokens
-			while (getline(iss, token, ',')) {
-				tokens.push_back(token);
-			}
 
-			// Check if the number of tokens is correct
-			if (tokens.size() == 4) {
-				// Compare the barcode with the desired barcode
-				if (tokens[1] == barcode) {
-					ProductInfo* productInfo = new ProductInfo{
-						tokens[0],  // Barcode Type
-						tokens[1],  // Barcode Number
-						tokens[2],  // Product name
-						tokens[3]   // Product description
-					};
-
-					inFile.close();  // Close the file
-					return productInfo;
-				}
-			}
+
+
+
+	// Copies the views into owned results, so later create, update or delete calls cannot invalidate them
+	static vector<ProductInfo> toProductInfo(const vector<ProductView>& products) {
+		vector<ProductInfo> productInfo;
+		productInfo.reserve(products.size());
+		for (const ProductView& product : products) {
+			productInfo.push_back(product.toProductInfo());
 		}
+		return productInfo;
+	}
 
-		inFile.close();  // Close the file
 
-		// If the barcode is not found, return nullptr
-		return nullptr;
+	// Function to list all products under a GS1 country or company prefix, sorted by barcode
+	vector<ProductInfo> getProductInfoByPrefix(const string& barcodePrefix) {
+		return toProductInfo(productDatabase.findByPrefix(barcodePrefix));
 	}
 
 
+	// Function to list all products with firstBarcode <= barcode <= lastBarcode, sorted by barcode
+	vector<ProductInfo> getProductInfoInRange(const string& firstBarcode, const string& lastBarcode) {
+		uint64_t firstBarcodeNumber, lastBarcodeNumber;
+		if (!ProductCatalog::encodeBarcode(firstBarcode, firstBarcodeNumber)
+			|| !ProductCatalog::encodeBarcode(lastBarcode, lastBarcodeNumber)) {
+			return {};
+		}
+		return toProductInfo(productDatabase.findRange(firstBarcodeNumber, lastBarcodeNumber));
+	}
+
 
 
 
 	void saveBarcodeInformation(const string& barcodeType, const string& barcodeNumber, const string& productName,
 		const string& productDescription) {
 		ProductInfo newProduct;
-		newProduct.barcodeType = barcodeType;
+		newProduct.barcodeType = withoutLineBreaks(barcodeType);
 		newProduct.barcodeNumber = barcodeNumber;
-		newProduct.productName = productName;
-		newProduct.productDescription = productDescription;
+		newProduct.productName = withoutLineBreaks(productName);
+		newProduct.productDescription = withoutLineBreaks(productDescription);
 
-		productDatabase.push_back(newProduct);
+		productDatabase.insert(newProduct.barcodeType, newProduct.barcodeNumber, newProduct.productName,
+			newProduct.productDescription);
 
 		saveBarcodeInformationCSV(newProduct.barcodeType, newProduct.barcodeNumber, newProduct.productName,
 			newProduct.productDescription);
+		invalidateCachedProduct(newProduct.barcodeNumber);
 		cout << "Product information created successfully." << endl;
 	}
 
@@ -126,8 +159,11 @@ namespace ip
 
 
 	void updateBarcodeInformation(const std::string& barcodeToUpdate, const std::string& newProductName, const std::string& newProductDescription) {
-		// Read existing information from the CSV file
-		std::vector<ProductInfo> allProductInfo;
+		const std::string productName = withoutLineBreaks(newProductName);
+		const std::string productDescription = withoutLineBreaks(newProductDescription);
+
+		// Read existing lines from the CSV file, rows of other barcodes are written back unchanged
+		std::vector<std::string> allLines;
 		std::ifstream inputFile("barcode_information.csv");
 
 		if (!inputFile.is_open()) {
@@ -137,23 +173,18 @@ namespace ip
 
 		std::string line;
 		while (std::getline(inputFile, line)) {
-			std::istringstream iss(line);
-			ProductInfo product;
-			std::getline(iss, product.barcodeType, ',');
-			std::getline(iss, product.barcodeNumber, ',');
-			std::getline(iss, product.productName, ',');
-			std::getline(iss, product.productDescription, ',');
-
-			allProductInfo.push_back(product);
+			allLines.push_back(line);
 		}
 
 		inputFile.close();
 
 		// Find the barcode to update and modify the information
-		for (std::vector<ProductInfo>::iterator it = allProductInfo.begin(); it != allProductInfo.end(); ++it) {
-			if (it->barcodeNumber == barcodeToUpdate) {
-				it->productName = newProductName;
-				it->productDescription = newProductDescription;
+		for (std::vector<std::string>::iterator it = allLines.begin(); it != allLines.end(); ++it) {
+			if (isProductRow(*it, barcodeToUpdate)) {
+				string_view fields[4];
+				string buffer;
+				splitCsvFields(*it, fields, 4);
+				*it = formatCsvRow(unquoteCsvField(fields[0], buffer), barcodeToUpdate, productName, productDescription);
 				break;  // Since the barcode is unique, no need to continue searching
 			}
 		}
@@ -167,12 +198,13 @@ namespace ip
 		}
 
 		// Write back all entries to the file
-		for (std::vector<ProductInfo>::const_iterator it = allProductInfo.begin(); it != allProductInfo.end(); ++it) {
-			outputFile << it->barcodeType << ',' << it->barcodeNumber << ','
-				<< it->productName << ',' << it->productDescription << std::endl;
+		for (std::vector<std::string>::const_iterator it = allLines.begin(); it != allLines.end(); ++it) {
+			outputFile << *it << std::endl;
 		}
 
 		outputFile.close();
+		productDatabase.update(barcodeToUpdate, productName, productDescription);
+		invalidateCachedProduct(barcodeToUpdate);
 
 		std::cout << "Product information for barcode " << barcodeToUpdate << " updated successfully." << std::endl;
 	}
@@ -180,8 +212,8 @@ namespace ip
 
 
 	void deleteBarcodeInformation(const std::string& barcodeToDelete) {
-		// Read existing information from the CSV file
-		std::vector<ProductInfo> allProductInfo;
+		// Read existing lines from the CSV file
+		std::vector<std::string> allLines;
 		std::ifstream inputFile("barcode_information.csv");
 
 		if (!inputFile.is_open()) {
@@ -192,26 +224,18 @@ namespace ip
 
 		std::string line;
 		while (getline(inputFile, line)) {
-			// Parse each line in the CSV file and store in vector
-			std::istringstream iss(line);
-			ProductInfo product;
-			getline(iss, product.barcodeType, ',');
-			getline(iss, product.barcodeNumber, ',');
-			getline(iss, product.productName, ',');
-			getline(iss, product.productDescription, ',');
-
-			allProductInfo.push_back(product);
+			allLines.push_back(line);
 		}
 
 		inputFile.close();
 
 		// Remove the entire line with the specified barcode
-		allProductInfo.erase(
-			std::remove_if(allProductInfo.begin(), allProductInfo.end(),
-				[barcodeToDelete](const ProductInfo& info) {
-					return info.barcodeNumber == barcodeToDelete;
+		allLines.erase(
+			std::remove_if(allLines.begin(), allLines.end(),
+				[&barcodeToDelete](const std::string& row) {
+					return isProductRow(row, barcodeToDelete);
 				}),
-			allProductInfo.end());
+			allLines.end());
 
 		// Open the file for writing
 		std::ofstream outputFile("barcode_information.csv");
@@ -223,12 +247,13 @@ namespace ip
 		}
 
 		// Write back all remaining entries to the file
-		for (const auto& info : allProductInfo) {
-			outputFile << info.barcodeType << ',' << info.barcodeNumber << ','
-				<< info.productName << ',' << info.productDescription << endl;
+		for (const auto& row : allLines) {
+			outputFile << row << endl;
 		}
 
 		outputFile.close();
+		productDatabase.erase(barcodeToDelete);
+		invalidateCachedProduct(barcodeToDelete);
 
 		cout << "Product information for barcode " << barcodeToDelete << " deleted successfully." << endl;
 	}
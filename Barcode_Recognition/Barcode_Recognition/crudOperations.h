@@ -17,6 +17,7 @@
 /* Include files */
 #include <opencv2/opencv.hpp>
 #include <string>
+#include "productCatalog.h"
 
 /* Namespaces */
 using namespace std;
@@ -32,11 +33,15 @@ namespace ip
 	};
 
 	ProductInfo* getProductInfoFromBarcode(const string& barcode);
+	vector<ProductInfo> getProductInfoByPrefix(const string& barcodePrefix);
+	vector<ProductInfo> getProductInfoInRange(const string& firstBarcode, const string& lastBarcode);
 	void saveBarcodeInformation(const string& barcodeType, const string& barcodeNumber, const string& productName, const string& productDescription);
 	void readBarcodeInformation();
 	void updateBarcodeInformation(const std::string& barcodeToUpdate, const std::string& newProductName, const std::string& newProductDescription);
 	void deleteBarcodeInformation(const string& barcodeToDelete);
 	void saveBarcodeInformationCSV(const string& barcodeType, const string& barcodeNumber);
+	size_t addProductsToDatabase(const ProductCatalog& products);
+	const ProductCatalog& getProductDatabase();
 
 	
 }
@@ -21,6 +21,8 @@
 #include <opencv2/opencv.hpp>
 #include "imageProcessing.h"
 #include "crudOperations.h"
+#include "catalogLoader.h"
+#include "productCache.h"
 #include <fstream>
 
 
@@ -61,9 +63,28 @@ void showLoadingAnimation(string word,int numDots, int delay);
 
 
 
+#ifndef CATALOG_BENCHMARK  // catalogBenchmark.cpp provides main() instead
 /* Main function */
 int main(void) {
     showLoadingAnimation("Loading",10, 200);
+
+    // Load the product catalog into memory
+    CatalogLoadStatistics loadStatistics;
+    if (loadProductDatabase("barcode_information.csv", &loadStatistics)) {
+        cout << "Catalog: " << loadStatistics.productsAdded << " products loaded ("
+            << loadStatistics.rowsRejected << " rejected rows) in " << loadStatistics.elapsedMilliseconds << " ms";
+        if (loadStatistics.elapsedMilliseconds > 0) {
+            cout << ", " << static_cast<size_t>(loadStatistics.rowsParsed * 1000.0 / loadStatistics.elapsedMilliseconds)
+                << " rows/s on " << loadStatistics.threadCount << " thread(s)";
+        }
+        cout << endl;
+
+        const ProductCatalog& catalog = getProductDatabase();
+        if (catalog.size() > 0) {
+            cout << "Catalog memory: " << catalog.memoryUsage() / 1024 << " KiB ("
+                << catalog.memoryUsage() / catalog.size() << " bytes per product)" << endl;
+        }
+    }
     cout << "\nThe EAN13 reader is ready for use" << endl;
 
     // variables
@@ -127,8 +148,13 @@ int main(void) {
             isreaded = get<1>(result);
         }
 
+        // ignore the event if the same barcode was just handled (item still in view)
+        if (isreaded && isRepeatedScan(get<0>(result))) {
+            cout << "Barcode " << get<0>(result) << " was already scanned, event ignored." << endl;
+            anotherBarcode = askForAnotherBarcode();
+        }
         // choose one Mode from the four Modes if the Barcode successfully readed
-        if (isreaded) {
+        else if (isreaded) {
             cout << "Barcode readed successfully" << endl;
             barcodeNumber = get<0>(result);
             cout << "Barcode Number: " << barcodeNumber << endl;
@@ -187,10 +213,16 @@ int main(void) {
        
     }
     
+    ProductCacheStatistics cacheStatistics = getProductCacheStatistics();
+    cout << "Lookup cache: " << cacheStatistics.hits << " unknown barcodes answered from the cache, "
+        << cacheStatistics.misses << " misses, hit rate " << cacheStatistics.hitRate() * 100 << " %, "
+        << cacheStatistics.savedLookupMilliseconds << " ms saved" << endl;
+
     showLoadingAnimation("Bye Bye", 5, 200);
     waitKey(1000);
     return 0;
 }
+#endif /* CATALOG_BENCHMARK */
 
 // Function to print product information
 void printProductInfo(const ProductInfo* productInfo) {
@@ -0,0 +1,162 @@
+/*****************************************************************************************************
+ * Automatische EAN-13-Barcodeerkennung mit OpenCV.
+ *****************************************************************************************************
+ * Autor: [Moussa Elgamal]
+ * Version: 04.02.2024
+ * Beschreibung:
+				Dieses C++-Programm implementiert die automatische EAN-13-Barcodeerkennung mithilfe der OpenCV-Bibliothek.
+				Es bietet vier Modi: Erstellen, Lesen, Aktualisieren und Lschen von Produktinformationen.
+				Das System erfasst Bilder, verbessert die Barcodeerkennung und ermglicht die Interaktion mit der Datenbank
+				fr verschiedene Anwendungsflle.
+ *****************************************************************************************************/
+
+
+/* Include files */
+#include <algorithm>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include "productCache.h"
+
+/* Namespaces */
+using namespace std;
+
+
+namespace ip
+{
+	namespace
+	{
+		using Clock = chrono::steady_clock;
+
+		struct CacheEntry {
+			Clock::time_point storedAt;
+			list<string>::iterator recentPosition;
+		};
+
+		size_t cacheCapacity = 1024;
+		chrono::milliseconds cacheTimeToLive(60000);
+		chrono::milliseconds scanDebounceWindow(1500);
+
+		mutex cacheMutex;
+		list<string> recentlyUsed;  // most recently used barcode first
+		unordered_map<string, CacheEntry> cacheEntries;
+		unordered_map<string, Clock::time_point> lastScanTimes;
+		ProductCacheStatistics statistics;
+		size_t unknownMisses = 0;
+		double totalUnknownMissMilliseconds = 0.0;	// database lookups of barcodes that were not found
+
+		void eraseEntry(unordered_map<string, CacheEntry>::iterator entry) {
+			recentlyUsed.erase(entry->second.recentPosition);
+			cacheEntries.erase(entry);
+		}
+
+		void evictToCapacity() {
+			while (cacheEntries.size() > cacheCapacity && !recentlyUsed.empty()) {
+				eraseEntry(cacheEntries.find(recentlyUsed.back()));
+			}
+		}
+	}
+
+
+	void configureProductCache(size_t capacity, chrono::milliseconds timeToLive, chrono::milliseconds debounceWindow) {
+		lock_guard<mutex> lock(cacheMutex);
+		cacheCapacity = capacity;
+		cacheTimeToLive = timeToLive;
+		scanDebounceWindow = debounceWindow;
+		evictToCapacity();
+	}
+
+
+	bool isCachedUnknownBarcode(const string& barcode) {
+		const Clock::time_point startTime = Clock::now();
+		lock_guard<mutex> lock(cacheMutex);
+
+		auto entry = cacheEntries.find(barcode);
+		if (entry == cacheEntries.end()) {
+			return false;
+		}
+		if (startTime - entry->second.storedAt > cacheTimeToLive) {
+			eraseEntry(entry);
+			return false;
+		}
+
+		// Move the entry to the front of the LRU list
+		recentlyUsed.splice(recentlyUsed.begin(), recentlyUsed, entry->second.recentPosition);
+
+		++statistics.hits;
+
+		if (unknownMisses > 0) {
+			const double averageMissMilliseconds = totalUnknownMissMilliseconds / unknownMisses;
+			const double hitMilliseconds = chrono::duration<double, milli>(Clock::now() - startTime).count();
+			statistics.savedLookupMilliseconds += max(0.0, averageMissMilliseconds - hitMilliseconds);
+		}
+		return true;
+	}
+
+
+	void storeDatabaseLookup(const string& barcode, bool found, double lookupMilliseconds) {
+		lock_guard<mutex> lock(cacheMutex);
+		++statistics.misses;
+
+		if (found) {
+			return;
+		}
+		++unknownMisses;
+		totalUnknownMissMilliseconds += lookupMilliseconds;
+
+		if (cacheCapacity == 0) {
+			return;
+		}
+
+		auto entry = cacheEntries.find(barcode);
+		if (entry != cacheEntries.end()) {
+			eraseEntry(entry);
+		}
+
+		recentlyUsed.push_front(barcode);
+		CacheEntry& newEntry = cacheEntries[barcode];
+		newEntry.storedAt = Clock::now();
+		newEntry.recentPosition = recentlyUsed.begin();
+
+		evictToCapacity();
+	}
+
+
+	void invalidateCachedProduct(const string& barcode) {
+		lock_guard<mutex> lock(cacheMutex);
+		auto entry = cacheEntries.find(barcode);
+		if (entry != cacheEntries.end()) {
+			eraseEntry(entry);
+			++statistics.invalidations;
+		}
+	}
+
+
+	bool isRepeatedScan(const string& barcode) {
+		const Clock::time_point now = Clock::now();
+		lock_guard<mutex> lock(cacheMutex);
+
+		// Forget codes whose window has passed, so the table stays as small as the set of items in view
+		if (lastScanTimes.size() > cacheCapacity) {
+			for (auto it = lastScanTimes.begin(); it != lastScanTimes.end();) {
+				it = (now - it->second > scanDebounceWindow) ? lastScanTimes.erase(it) : next(it);
+			}
+		}
+
+		auto lastScan = lastScanTimes.find(barcode);
+		const bool repeated = scanDebounceWindow.count() > 0 && lastScan != lastScanTimes.end()
+			&& now - lastScan->second <= scanDebounceWindow;
+		lastScanTimes[barcode] = now;
+
+		if (repeated) {
+			++statistics.suppressedScans;
+		}
+		return repeated;
+	}
+
+
+	ProductCacheStatistics getProductCacheStatistics() {
+		lock_guard<mutex> lock(cacheMutex);
+		return statistics;
+	}
+}
@@ -0,0 +1,56 @@
+/*****************************************************************************************************
+ * Automatische EAN-13-Barcodeerkennung mit OpenCV.
+ *****************************************************************************************************
+ * Autor: [Moussa Elgamal]
+ * Version: 04.02.2024
+ * Beschreibung:
+				Dieses C++-Programm implementiert die automatische EAN-13-Barcodeerkennung mithilfe der OpenCV-Bibliothek.
+				Es bietet vier Modi: Erstellen, Lesen, Aktualisieren und Lschen von Produktinformationen.
+				Das System erfasst Bilder, verbessert die Barcodeerkennung und ermglicht die Interaktion mit der Datenbank
+				fr verschiedene Anwendungsflle.
+ *****************************************************************************************************/
+
+#pragma once
+#ifndef IP_PRODUCT_CACHE_H
+#define IP_PRODUCT_CACHE_H
+
+/* Include files */
+#include <chrono>
+#include <string>
+#include "crudOperations.h"
+
+/* Namespaces */
+using namespace std;
+
+namespace ip
+{
+	struct ProductCacheStatistics {
+		size_t hits = 0;				// unknown barcodes answered from the cache
+		size_t misses = 0;				// lookups that had to query the product database
+		size_t invalidations = 0;		// cached unknown barcodes dropped by create, update or delete
+		size_t suppressedScans = 0;		// scan events ignored by the debounce window
+		double savedLookupMilliseconds = 0.0;	// per hit: average database lookup time of an unknown barcode minus the hit time
+
+		double hitRate() const { return (hits + misses) > 0 ? static_cast<double>(hits) / (hits + misses) : 0.0; }
+	};
+
+	// Bounded LRU cache of barcodes recently looked up without a match in the product database. Entries older
+	// than timeToLive are treated as misses. Found products are not cached: the in-memory catalog answers them
+	// with a binary search, which is cheaper than copying a ProductInfo into and out of the cache.
+	// Defaults: 1024 entries, 60 s time to live, 1500 ms debounce window.
+	void configureProductCache(size_t capacity, chrono::milliseconds timeToLive, chrono::milliseconds debounceWindow);
+
+	// Returns true if the barcode was recently looked up and is not in the product database
+	bool isCachedUnknownBarcode(const string& barcode);
+	// Counts a database lookup and the time it took, and caches the barcode if it was not found
+	void storeDatabaseLookup(const string& barcode, bool found, double lookupMilliseconds);
+	void invalidateCachedProduct(const string& barcode);
+
+	// Returns true if the same barcode was already scanned within the debounce window.
+	// Every call restarts the window, so an item that stays in view keeps being suppressed.
+	bool isRepeatedScan(const string& barcode);
+
+	ProductCacheStatistics getProductCacheStatistics();
+}
+
+#endif /* IP_PRODUCT_CACHE_H */
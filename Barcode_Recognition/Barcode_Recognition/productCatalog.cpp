@@ -0,0 +1,457 @@
+/*****************************************************************************************************
+ * Automatische EAN-13-Barcodeerkennung mit OpenCV.
+ *****************************************************************************************************
+ * Autor: [Moussa Elgamal]
+ * Version: 04.02.2024
+ * Beschreibung:
+				Dieses C++-Programm implementiert die automatische EAN-13-Barcodeerkennung mithilfe der OpenCV-Bibliothek.
+				Es bietet vier Modi: Erstellen, Lesen, Aktualisieren und Lschen von Produktinformationen.
+				Das System erfasst Bilder, verbessert die Barcodeerkennung und ermglicht die Interaktion mit der Datenbank
+				fr verschiedene Anwendungsflle.
+ *****************************************************************************************************/
+
+
+/* Include files */
+#include <algorithm>
+#include <limits>
+#include "productCatalog.h"
+#include "crudOperations.h"
+
+/* Namespaces */
+using namespace std;
+
+
+namespace ip
+{
+	namespace
+	{
+		const size_t EAN13_LENGTH = 13;
+		const size_t MAX_ARENA_SIZE = numeric_limits<uint32_t>::max();
+		const size_t MAX_BARCODE_TYPES = numeric_limits<uint8_t>::max() + 1;
+
+		// Converts a barcode prefix into the range of all 13-digit numbers starting with it
+		bool prefixToRange(string_view prefix, uint64_t& first, uint64_t& last) {
+			if (prefix.size() > EAN13_LENGTH) {
+				return false;
+			}
+
+			uint64_t value = 0;
+			for (char ch : prefix) {
+				if (ch < '0' || ch > '9') {
+					return false;
+				}
+				value = value * 10 + static_cast<uint64_t>(ch - '0');
+			}
+
+			uint64_t width = 1;
+			for (size_t i = prefix.size(); i < EAN13_LENGTH; ++i) {
+				width *= 10;
+			}
+
+			first = value * width;
+			last = first + width - 1;
+			return true;
+		}
+	}
+
+
+	ProductInfo ProductView::toProductInfo() const {
+		return ProductInfo{
+			string(barcodeType),
+			ProductCatalog::decodeBarcode(barcodeNumber),
+			string(productName),
+			string(productDescription)
+		};
+	}
+
+
+	bool ProductCatalog::encodeBarcode(string_view barcode, uint64_t& barcodeNumber) {
+		if (barcode.size() != EAN13_LENGTH) {
+			return false;
+		}
+
+		barcodeNumber = 0;
+		for (char ch : barcode) {
+			if (ch < '0' || ch > '9') {
+				return false;
+			}
+			barcodeNumber = barcodeNumber * 10 + static_cast<uint64_t>(ch - '0');
+		}
+		return true;
+	}
+
+
+	string ProductCatalog::decodeBarcode(uint64_t barcodeNumber) {
+		// Fixed width, so leading zeros (e.g. UPC-A codes stored as EAN-13) are kept
+		string barcode(EAN13_LENGTH, '0');
+		for (size_t i = EAN13_LENGTH; i-- > 0 && barcodeNumber > 0;) {
+			barcode[i] = static_cast<char>('0' + barcodeNumber % 10);
+			barcodeNumber /= 10;
+		}
+		return barcode;
+	}
+
+
+	bool ProductCatalog::insert(string_view barcodeType, string_view barcodeNumber, string_view productName,
+		string_view productDescription) {
+		uint64_t key;
+		uint32_t slot;
+		if (!encodeBarcode(barcodeNumber, key) || (indexed && locate(key, slot))
+			|| !insertEntry(key, barcodeType, productName, productDescription)) {
+			return false;
+		}
+
+		if (indexed) {
+			const OrderedKey orderedKey{ key, static_cast<uint32_t>(entries.size() - 1) };
+			recentKeys.insert(recentKeys.begin() + lowerBound(recentKeys, key), orderedKey);
+			if (recentKeys.size() > MAX_RECENT_KEYS) {
+				mergeOrderedIndex();
+			}
+		}
+		return true;
+	}
+
+
+	bool ProductCatalog::insertEntry(uint64_t barcodeNumber, string_view barcodeType, string_view productName,
+		string_view productDescription) {
+		if (!reserveText(productName.size() + productDescription.size())) {
+			return false;
+		}
+
+		const size_t typeId = internBarcodeType(barcodeType);
+		if (typeId >= MAX_BARCODE_TYPES) {
+			return false;
+		}
+
+		Entry entry;
+		entry.barcodeNumber = barcodeNumber;
+		entry.typeId = static_cast<uint8_t>(typeId);
+		entry.textOffset = appendText(productName, productDescription);
+		entry.nameLength = static_cast<uint32_t>(productName.size());
+		entry.descriptionLength = static_cast<uint32_t>(productDescription.size());
+
+		entries.push_back(entry);
+		return true;
+	}
+
+
+	size_t ProductCatalog::append(const ProductCatalog& other) {
+		size_t addedCount = 0;
+		reserve(entries.size() + other.entries.size(), arena.size() + other.arena.size());
+
+		if (!indexed) {
+			for (const Entry& entry : other.entries) {
+				const ProductView product = other.makeView(entry);
+				if (insertEntry(product.barcodeNumber, product.barcodeType, product.productName, product.productDescription)) {
+					++addedCount;
+				}
+			}
+			return addedCount;
+		}
+
+		// Sort the new products by barcode once; the stable sort keeps the first of several equal barcodes in front
+		vector<OrderedKey> newKeys(other.entries.size());
+		for (size_t slot = 0; slot < other.entries.size(); ++slot) {
+			newKeys[slot] = OrderedKey{ other.entries[slot].barcodeNumber, static_cast<uint32_t>(slot) };
+		}
+		stable_sort(newKeys.begin(), newKeys.end(),
+			[](const OrderedKey& left, const OrderedKey& right) { return left.barcodeNumber < right.barcodeNumber; });
+
+		vector<OrderedKey> addedKeys;
+		for (size_t i = 0; i < newKeys.size(); ++i) {
+			uint32_t slot;
+			if ((i > 0 && newKeys[i].barcodeNumber == newKeys[i - 1].barcodeNumber) || locate(newKeys[i].barcodeNumber, slot)) {
+				continue;  // Barcode is already in the catalog
+			}
+
+			const ProductView product = other.makeView(other.entries[newKeys[i].slot]);
+			if (insertEntry(product.barcodeNumber, product.barcodeType, product.productName, product.productDescription)) {
+				addedKeys.push_back(OrderedKey{ product.barcodeNumber, static_cast<uint32_t>(entries.size() - 1) });
+				++addedCount;
+			}
+		}
+
+		// recentKeys may already hold keys from single inserts
+		recentKeys.insert(recentKeys.end(), addedKeys.begin(), addedKeys.end());
+		inplace_merge(recentKeys.begin(), recentKeys.end() - addedKeys.size(), recentKeys.end(),
+			[](const OrderedKey& left, const OrderedKey& right) { return left.barcodeNumber < right.barcodeNumber; });
+		mergeOrderedIndex();
+
+		return addedCount;
+	}
+
+
+	bool ProductCatalog::update(const string& barcodeNumber, string_view productName, string_view productDescription) {
+		uint64_t key;
+		if (!encodeBarcode(barcodeNumber, key)) {
+			return false;
+		}
+		uint32_t slot;
+		if (!locate(key, slot) || !reserveText(productName.size() + productDescription.size())) {
+			return false;
+		}
+
+		// The old text stays in the arena until the next compaction
+		Entry& entry = entries[slot];
+		unusedArenaBytes += entry.nameLength + entry.descriptionLength;
+		entry.textOffset = appendText(productName, productDescription);
+		entry.nameLength = static_cast<uint32_t>(productName.size());
+		entry.descriptionLength = static_cast<uint32_t>(productDescription.size());
+
+		if (unusedArenaBytes > arena.size() / 2) {
+			compactArena();
+		}
+		return true;
+	}
+
+
+	bool ProductCatalog::erase(const string& barcodeNumber) {
+		uint64_t key;
+		if (!encodeBarcode(barcodeNumber, key)) {
+			return false;
+		}
+		uint32_t slot;
+		if (!locate(key, slot)) {
+			return false;
+		}
+
+		// Move the last entry into the gap
+		unusedArenaBytes += entries[slot].nameLength + entries[slot].descriptionLength;
+		if (indexed) {
+			// Recent keys are removed right away, merged keys are only marked as erased
+			const size_t recentPosition = lowerBound(recentKeys, key);
+			if (recentPosition < recentKeys.size() && recentKeys[recentPosition].barcodeNumber == key) {
+				recentKeys.erase(recentKeys.begin() + recentPosition);
+			}
+			else {
+				findOrderedKey(key)->slot = ERASED_SLOT;
+				++erasedKeyCount;
+			}
+		}
+		if (slot + 1 != entries.size()) {
+			entries[slot] = entries.back();
+			if (indexed) {
+				findOrderedKey(entries[slot].barcodeNumber)->slot = slot;
+			}
+		}
+		entries.pop_back();
+
+		if (erasedKeyCount > orderedIndex.size() / 2) {
+			mergeOrderedIndex();
+		}
+
+		if (unusedArenaBytes > arena.size() / 2) {
+			compactArena();
+		}
+		return true;
+	}
+
+
+	bool ProductCatalog::find(const string& barcodeNumber, ProductView& product) const {
+		uint64_t key;
+		if (!encodeBarcode(barcodeNumber, key)) {
+			return false;
+		}
+		uint32_t slot;
+		if (!locate(key, slot)) {
+			return false;
+		}
+
+		product = makeView(entries[slot]);
+		return true;
+	}
+
+
+	vector<ProductView> ProductCatalog::findByPrefix(string_view barcodePrefix) const {
+		uint64_t firstBarcodeNumber, lastBarcodeNumber;
+		if (!prefixToRange(barcodePrefix, firstBarcodeNumber, lastBarcodeNumber)) {
+			return {};
+		}
+		return findRange(firstBarcodeNumber, lastBarcodeNumber);
+	}
+
+
+	vector<ProductView> ProductCatalog::findRange(uint64_t firstBarcodeNumber, uint64_t lastBarcodeNumber) const {
+		vector<ProductView> products;
+		if (firstBarcodeNumber > lastBarcodeNumber) {
+			return products;
+		}
+
+		// Staging catalogs have no ordered index
+		if (!indexed) {
+			for (const Entry& entry : entries) {
+				if (entry.barcodeNumber >= firstBarcodeNumber && entry.barcodeNumber <= lastBarcodeNumber) {
+					products.push_back(makeView(entry));
+				}
+			}
+			sort(products.begin(), products.end(),
+				[](const ProductView& left, const ProductView& right) { return left.barcodeNumber < right.barcodeNumber; });
+			return products;
+		}
+
+		// Walk both sorted parts of the ordered index side by side, skipping erased keys
+		size_t mergedPosition = lowerBound(orderedIndex, firstBarcodeNumber);
+		size_t recentPosition = lowerBound(recentKeys, firstBarcodeNumber);
+		while (true) {
+			bool takeMerged = mergedPosition < orderedIndex.size() && orderedIndex[mergedPosition].barcodeNumber <= lastBarcodeNumber;
+			bool takeRecent = recentPosition < recentKeys.size() && recentKeys[recentPosition].barcodeNumber <= lastBarcodeNumber;
+			if (!takeMerged && !takeRecent) {
+				break;
+			}
+			if (takeMerged && takeRecent) {
+				takeMerged = orderedIndex[mergedPosition].barcodeNumber < recentKeys[recentPosition].barcodeNumber;
+			}
+
+			const OrderedKey& key = takeMerged ? orderedIndex[mergedPosition++] : recentKeys[recentPosition++];
+			if (key.slot != ERASED_SLOT) {
+				products.push_back(makeView(entries[key.slot]));
+			}
+		}
+
+		return products;
+	}
+
+
+	void ProductCatalog::reserve(size_t productCount, size_t textBytes) {
+		entries.reserve(productCount);
+		arena.reserve(min(textBytes, MAX_ARENA_SIZE));
+	}
+
+
+	size_t ProductCatalog::memoryUsage() const {
+		size_t bytes = entries.capacity() * sizeof(Entry) + arena.capacity()
+			+ (orderedIndex.capacity() + recentKeys.capacity()) * sizeof(OrderedKey);
+
+		for (const string& barcodeType : barcodeTypes) {
+			bytes += sizeof(string) + barcodeType.capacity();
+		}
+		return bytes;
+	}
+
+
+	bool ProductCatalog::locate(uint64_t barcodeNumber, uint32_t& slot) const {
+		if (indexed) {
+			const OrderedKey* orderedKey = findOrderedKey(barcodeNumber);
+			if (orderedKey == nullptr) {
+				return false;
+			}
+			slot = orderedKey->slot;
+			return true;
+		}
+
+		for (size_t i = 0; i < entries.size(); ++i) {
+			if (entries[i].barcodeNumber == barcodeNumber) {
+				slot = static_cast<uint32_t>(i);
+				return true;
+			}
+		}
+		return false;
+	}
+
+
+	size_t ProductCatalog::internBarcodeType(string_view barcodeType) {
+		for (size_t typeId = 0; typeId < barcodeTypes.size(); ++typeId) {
+			if (barcodeTypes[typeId] == barcodeType) {
+				return typeId;
+			}
+		}
+
+		if (barcodeTypes.size() == MAX_BARCODE_TYPES) {
+			return MAX_BARCODE_TYPES;  // No free id left
+		}
+		barcodeTypes.emplace_back(barcodeType);
+		return barcodeTypes.size() - 1;
+	}
+
+
+	// Offsets are 32 bit, so the arena must not grow beyond 4 GiB
+	bool ProductCatalog::reserveText(size_t textBytes) {
+		if (arena.size() + textBytes > MAX_ARENA_SIZE && unusedArenaBytes > 0) {
+			compactArena();
+		}
+		return arena.size() + textBytes <= MAX_ARENA_SIZE;
+	}
+
+
+	uint32_t ProductCatalog::appendText(string_view productName, string_view productDescription) {
+		const uint32_t textOffset = static_cast<uint32_t>(arena.size());
+		arena.append(productName);
+		arena.append(productDescription);
+		return textOffset;
+	}
+
+
+	ProductView ProductCatalog::makeView(const Entry& entry) const {
+		const string_view text(arena.data() + entry.textOffset, entry.nameLength + entry.descriptionLength);
+		return ProductView{
+			entry.barcodeNumber,
+			barcodeTypes[entry.typeId],
+			text.substr(0, entry.nameLength),
+			text.substr(entry.nameLength)
+		};
+	}
+
+
+	void ProductCatalog::compactArena() {
+		string compacted;
+		compacted.reserve(arena.size() - unusedArenaBytes);
+
+		for (Entry& entry : entries) {
+			const uint32_t textOffset = static_cast<uint32_t>(compacted.size());
+			compacted.append(arena, entry.textOffset, entry.nameLength + entry.descriptionLength);
+			entry.textOffset = textOffset;
+		}
+
+		arena.swap(compacted);
+		unusedArenaBytes = 0;
+	}
+
+
+	size_t ProductCatalog::lowerBound(const vector<OrderedKey>& keys, uint64_t barcodeNumber) {
+		return lower_bound(keys.begin(), keys.end(), barcodeNumber,
+			[](const OrderedKey& orderedKey, uint64_t key) { return orderedKey.barcodeNumber < key; }) - keys.begin();
+	}
+
+
+	// Ordered index key of a barcode, nullptr if the barcode is not in the catalog
+	const ProductCatalog::OrderedKey* ProductCatalog::findOrderedKey(uint64_t barcodeNumber) const {
+		const size_t recentPosition = lowerBound(recentKeys, barcodeNumber);
+		if (recentPosition < recentKeys.size() && recentKeys[recentPosition].barcodeNumber == barcodeNumber) {
+			return &recentKeys[recentPosition];
+		}
+
+		const size_t mergedPosition = lowerBound(orderedIndex, barcodeNumber);
+		if (mergedPosition < orderedIndex.size() && orderedIndex[mergedPosition].barcodeNumber == barcodeNumber
+			&& orderedIndex[mergedPosition].slot != ERASED_SLOT) {
+			return &orderedIndex[mergedPosition];
+		}
+		return nullptr;
+	}
+
+
+	ProductCatalog::OrderedKey* ProductCatalog::findOrderedKey(uint64_t barcodeNumber) {
+		return const_cast<OrderedKey*>(static_cast<const ProductCatalog*>(this)->findOrderedKey(barcodeNumber));
+	}
+
+
+	// Drops erased keys and merges the recent keys into the ordered index in O(n)
+	void ProductCatalog::mergeOrderedIndex() {
+		orderedIndex.erase(
+			remove_if(orderedIndex.begin(), orderedIndex.end(),
+				[](const OrderedKey& orderedKey) { return orderedKey.slot == ERASED_SLOT; }),
+			orderedIndex.end());
+
+		// Exact sizes: the merge copies everything anyway, and a bulk append must not leave spare capacity behind
+		const size_t mergedCount = orderedIndex.size();
+		orderedIndex.reserve(mergedCount + recentKeys.size());
+		orderedIndex.insert(orderedIndex.end(), recentKeys.begin(), recentKeys.end());
+		inplace_merge(orderedIndex.begin(), orderedIndex.begin() + mergedCount, orderedIndex.end(),
+			[](const OrderedKey& left, const OrderedKey& right) { return left.barcodeNumber < right.barcodeNumber; });
+
+		recentKeys.clear();
+		if (recentKeys.capacity() > MAX_RECENT_KEYS + 1) {
+			vector<OrderedKey>().swap(recentKeys);
+		}
+		erasedKeyCount = 0;
+	}
+}
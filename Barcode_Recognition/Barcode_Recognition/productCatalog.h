@@ -0,0 +1,117 @@
+/*****************************************************************************************************
+ * Automatische EAN-13-Barcodeerkennung mit OpenCV.
+ *****************************************************************************************************
+ * Autor: [Moussa Elgamal]
+ * Version: 04.02.2024
+ * Beschreibung:
+				Dieses C++-Programm implementiert die automatische EAN-13-Barcodeerkennung mithilfe der OpenCV-Bibliothek.
+				Es bietet vier Modi: Erstellen, Lesen, Aktualisieren und Lschen von Produktinformationen.
+				Das System erfasst Bilder, verbessert die Barcodeerkennung und ermglicht die Interaktion mit der Datenbank
+				fr verschiedene Anwendungsflle.
+ *****************************************************************************************************/
+
+#pragma once
+#ifndef IP_PRODUCT_CATALOG_H
+#define IP_PRODUCT_CATALOG_H
+
+/* Include files */
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/* Namespaces */
+using namespace std;
+
+namespace ip
+{
+	struct ProductInfo;
+
+	// Read-only view of one catalog product. The string views point into the catalog
+	// and stay valid until the catalog is modified.
+	struct ProductView {
+		uint64_t barcodeNumber;
+		string_view barcodeType;
+		string_view productName;
+		string_view productDescription;
+
+		ProductInfo toProductInfo() const;
+	};
+
+	// Compact in-memory product catalog: EAN-13 numbers are stored as integers, barcode types are
+	// interned into a small id table and names and descriptions live in one contiguous string arena.
+	// An unindexed catalog is an append-only staging buffer for bulk loads: insert() does not reject
+	// duplicate barcodes and lookups scan linearly.
+	// Threading: const member functions may run concurrently. Non-const ones need exclusive access and
+	// invalidate all ProductViews handed out before.
+	class ProductCatalog {
+	public:
+		explicit ProductCatalog(bool indexed = true) : indexed(indexed) {}
+
+		static bool encodeBarcode(string_view barcode, uint64_t& barcodeNumber);
+		static string decodeBarcode(uint64_t barcodeNumber);
+
+		// Returns false if the barcode is not a 13-digit number or already in the catalog
+		bool insert(string_view barcodeType, string_view barcodeNumber, string_view productName, string_view productDescription);
+		// Adds all products of 'other' whose barcode is not yet in this catalog, returns the number of added products
+		size_t append(const ProductCatalog& other);
+		bool update(const string& barcodeNumber, string_view productName, string_view productDescription);
+		bool erase(const string& barcodeNumber);
+		bool find(const string& barcodeNumber, ProductView& product) const;
+		// Ordered queries in O(log n + k), results sorted by barcode number. The prefix is 0 to 13 digits,
+		// e.g. a GS1 country or company prefix; an invalid prefix or range returns no products.
+		// Single inserts cost amortized O(MAX_RECENT_KEYS + n / MAX_RECENT_KEYS) key moves for the
+		// ordered index, erases amortized O(log n).
+		vector<ProductView> findByPrefix(string_view barcodePrefix) const;
+		vector<ProductView> findRange(uint64_t firstBarcodeNumber, uint64_t lastBarcodeNumber) const;
+
+		void reserve(size_t productCount, size_t textBytes);
+		size_t size() const { return entries.size(); }
+		// Bytes allocated by the catalog, including the index
+		size_t memoryUsage() const;
+
+	private:
+		struct Entry {
+			uint64_t barcodeNumber;
+			uint32_t textOffset;		// product name, directly followed by the description
+			uint32_t nameLength;
+			uint32_t descriptionLength;
+			uint8_t typeId;
+		};
+
+		struct OrderedKey {
+			uint64_t barcodeNumber;
+			uint32_t slot;		// position in entries, ERASED_SLOT for an erased product
+		};
+
+		static constexpr uint32_t ERASED_SLOT = 0xFFFFFFFF;
+		static constexpr size_t MAX_RECENT_KEYS = 4096;
+
+		bool locate(uint64_t barcodeNumber, uint32_t& slot) const;
+		bool insertEntry(uint64_t barcodeNumber, string_view barcodeType, string_view productName, string_view productDescription);
+		size_t internBarcodeType(string_view barcodeType);
+		bool reserveText(size_t textBytes);
+		uint32_t appendText(string_view productName, string_view productDescription);
+		ProductView makeView(const Entry& entry) const;
+		void compactArena();
+		static size_t lowerBound(const vector<OrderedKey>& keys, uint64_t barcodeNumber);
+		const OrderedKey* findOrderedKey(uint64_t barcodeNumber) const;
+		OrderedKey* findOrderedKey(uint64_t barcodeNumber);
+		void mergeOrderedIndex();
+
+		bool indexed;
+		vector<Entry> entries;
+		string arena;
+		size_t unusedArenaBytes = 0;	// text of updated or erased products
+		vector<string> barcodeTypes;	// typeId -> barcode type, e.g. "EAN13"
+
+		// Ordered index of an indexed catalog, both parts sorted by barcode number; it also serves exact
+		// lookups in O(log n). Erases only mark the key in orderedIndex, single inserts go to the small
+		// recentKeys; both are folded into orderedIndex once recentKeys is full or half of orderedIndex is erased.
+		vector<OrderedKey> orderedIndex;
+		vector<OrderedKey> recentKeys;
+		size_t erasedKeyCount = 0;
+	};
+}
+
+#endif /* IP_PRODUCT_CATALOG_H */